@@ -0,0 +1,218 @@
+#include "bound.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+
+static const double INFEASIBLE = -numeric_limits<double>::infinity();
+
+UpperBound::UpperBound(const SetCoverQBF& scqbf, int nodeLimit)
+    : m(scqbf.getNumSets()), nodeLimit(nodeLimit), bestValue(-1e18) {
+    linear.assign(m, 0.0);
+    Q.assign(m, vector<double>(m, 0.0));
+    for (int i = 0; i < m; i++) {
+        linear[i] = scqbf.getLinearCoeff(i);
+        for (int j = i + 1; j < m; j++) {
+            Q[i][j] = Q[j][i] = scqbf.getQuadraticCoeff(i, j);
+        }
+    }
+
+    // Map elements to contiguous indexes
+    map<int, int> elementIndex;
+    for (int element : scqbf.getUniverse()) {
+        int index = static_cast<int>(elementIndex.size());
+        elementIndex[element] = index;
+    }
+
+    setElements.assign(m, {});
+    coverers.assign(elementIndex.size(), {});
+    for (int i = 0; i < m; i++) {
+        for (int element : scqbf.getSet(i)) {
+            int e = elementIndex[element];
+            setElements[i].push_back(e);
+            coverers[e].push_back(i);
+        }
+    }
+}
+
+// Fixes to 1 every free set that is the only remaining coverer of an uncovered element.
+// Returns false if some element can no longer be covered.
+bool UpperBound::propagateCoverage(vector<signed char>& state) const {
+    int numElements = static_cast<int>(coverers.size());
+    vector<char> covered(numElements, 0);
+    for (int i = 0; i < m; i++) {
+        if (state[i] == 1) {
+            for (int e : setElements[i]) covered[e] = 1;
+        }
+    }
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int e = 0; e < numElements; e++) {
+            if (covered[e]) continue;
+
+            int freeCount = 0;
+            int lastFree = -1;
+            for (int i : coverers[e]) {
+                if (state[i] == FREE) {
+                    freeCount++;
+                    lastFree = i;
+                }
+            }
+
+            if (freeCount == 0) return false;
+            if (freeCount == 1) {
+                state[lastFree] = 1;
+                for (int f : setElements[lastFree]) covered[f] = 1;
+                changed = true;
+            }
+        }
+    }
+
+    return true;
+}
+
+// Returns an upper bound for the subtree rooted at state (after propagation),
+// or INFEASIBLE. branchVar is set to the free variable to branch on, or -1 at a leaf.
+double UpperBound::evaluateNode(vector<signed char>& state, int& branchVar, bool& branchOneFirst) const {
+    branchVar = -1;
+    branchOneFirst = true;
+
+    if (!propagateCoverage(state)) return INFEASIBLE;
+
+    vector<int> ones, freeVars;
+    for (int i = 0; i < m; i++) {
+        if (state[i] == 1) ones.push_back(i);
+        else if (state[i] == FREE) freeVars.push_back(i);
+    }
+
+    // Value of the fixed part
+    double base = 0.0;
+    for (size_t a = 0; a < ones.size(); a++) {
+        base += linear[ones[a]];
+        for (size_t b = a + 1; b < ones.size(); b++) {
+            base += Q[ones[a]][ones[b]];
+        }
+    }
+
+    if (freeVars.empty()) return base;
+
+    // Per-variable bounds: positive free-free terms either charged to the lower index (forward)
+    // or split evenly between both ends (half). Both are valid, so the smaller total is kept.
+    vector<double> forward(m, 0.0), half(m, 0.0);
+    for (int i : freeVars) {
+        double fixedPart = linear[i];
+        for (int j : ones) fixedPart += Q[i][j];
+
+        double fwd = 0.0, all = 0.0;
+        for (int j : freeVars) {
+            if (j == i) continue;
+            double q = max(0.0, Q[i][j]);
+            all += q;
+            if (j > i) fwd += q;
+        }
+        forward[i] = fixedPart + fwd;
+        half[i] = fixedPart + 0.5 * all;
+    }
+
+    // Every uncovered element needs one of its free coverers. When all of them have a
+    // negative bound, the least negative one is charged; groups are kept disjoint.
+    int numElements = static_cast<int>(coverers.size());
+    vector<char> covered(numElements, 0);
+    for (int i : ones) {
+        for (int e : setElements[i]) covered[e] = 1;
+    }
+
+    auto boundFor = [&](const vector<double>& u) {
+        double total = base;
+        for (int i : freeVars) total += max(0.0, u[i]);
+
+        vector<char> used(m, 0);
+        for (int e = 0; e < numElements; e++) {
+            if (covered[e]) continue;
+            double bestCoverer = INFEASIBLE;
+            bool disjoint = true;
+            for (int i : coverers[e]) {
+                if (state[i] != FREE) continue;
+                if (used[i]) {
+                    disjoint = false;
+                    break;
+                }
+                bestCoverer = max(bestCoverer, u[i]);
+            }
+            if (!disjoint || bestCoverer >= 0.0) continue;
+            total += bestCoverer;
+            for (int i : coverers[e]) used[i] = 1;
+        }
+        return total;
+    };
+
+    double bound = min(boundFor(forward), boundFor(half));
+
+    // Branch on the free variable with the largest bound magnitude
+    double bestScore = -1.0;
+    for (int i : freeVars) {
+        double score = fabs(forward[i]);
+        if (score > bestScore) {
+            bestScore = score;
+            branchVar = i;
+            branchOneFirst = forward[i] > 0.0;
+        }
+    }
+
+    // Coefficients are integers, so is the optimum
+    return floor(bound + 1e-9);
+}
+
+double UpperBound::rootBound() {
+    vector<signed char> state(m, FREE);
+    int branchVar;
+    bool branchOneFirst;
+    return evaluateNode(state, branchVar, branchOneFirst);
+}
+
+double UpperBound::branch(vector<signed char> state) {
+    int branchVar;
+    bool branchOneFirst;
+    double bound = evaluateNode(state, branchVar, branchOneFirst);
+    nodesExplored++;
+
+    if (bound == INFEASIBLE) return bound;
+
+    if (branchVar < 0) {
+        // Leaf: bound is the exact value of a feasible solution
+        if (bound > bestValue) {
+            bestValue = bound;
+            bestSolution = Solution(m);
+            for (int i = 0; i < m; i++) {
+                if (state[i] == 1) bestSolution.set(i);
+            }
+        }
+        return bound;
+    }
+
+    if (bound <= bestValue) return bound;
+
+    if (nodesExplored >= nodeLimit) {
+        limitReached = true;
+        return bound;
+    }
+
+    state[branchVar] = branchOneFirst ? 1 : 0;
+    double first = branch(state);
+    state[branchVar] = branchOneFirst ? 0 : 1;
+    double second = branch(state);
+
+    return min(bound, max(first, second));
+}
+
+double UpperBound::compute(double incumbent) {
+    nodesExplored = 0;
+    limitReached = false;
+    bestValue = incumbent;
+    bestSolution = Solution();
+
+    double bound = branch(vector<signed char>(m, FREE));
+    return max(bestValue, bound);
+}
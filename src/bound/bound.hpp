@@ -0,0 +1,52 @@
+#ifndef BOUND_HPP
+#define BOUND_HPP
+
+#include "../sc-qbf/sc_qbf.hpp"
+#include <vector>
+
+using namespace std;
+
+// Upper bounds for MAX-SC-QBF: per-variable bounds from positive quadratic terms
+// and forced-coverage reasoning, tightened by a node-limited depth-first branch-and-bound
+class UpperBound {
+public:
+    static constexpr signed char FREE = -1;
+
+private:
+    int m;
+    int nodeLimit;
+    vector<double> linear; // Linear coefficients
+    vector<vector<double>> Q; // Symmetric dense matrix of quadratic coefficients
+    vector<vector<int>> setElements; // Elements of each set, as universe indexes
+    vector<vector<int>> coverers; // Sets covering each universe element
+
+    long long nodesExplored = 0;
+    bool limitReached = false;
+    double bestValue;
+    Solution bestSolution;
+
+public:
+    UpperBound(const SetCoverQBF& scqbf, int nodeLimit = 5000);
+
+    // Bound of the root node, without branching
+    double rootBound();
+
+    // Runs the branch-and-bound and returns a proven upper bound on the optimum.
+    // incumbent is the value of a known feasible solution, used for pruning.
+    double compute(double incumbent = -1e18);
+
+    bool isProvenOptimal() const { return !limitReached; }
+    long long getNodesExplored() const { return nodesExplored; }
+    double getBestValue() const { return bestValue; }
+    const Solution& getBestSolution() const { return bestSolution; }
+
+    void setNodeLimit(int limit) { nodeLimit = limit; }
+    int getNodeLimit() const { return nodeLimit; }
+
+private:
+    double evaluateNode(vector<signed char>& state, int& branchVar, bool& branchOneFirst) const;
+    bool propagateCoverage(vector<signed char>& state) const;
+    double branch(vector<signed char> state);
+};
+
+#endif
@@ -1,34 +1,68 @@
 #include "grasp.hpp"
+#include "../bound/bound.hpp"
+#include "../sc-qbf/presolve.hpp"
 #include <algorithm>
 #include <random>
 #include <chrono>
 #include <set>
 #include <iostream>
 #include <climits>
+#include <cmath>
 
 GRASP::GRASP() : alpha(0.1), maxIterations(1000), timeLimit(1800), // 30 minutes
-constructionMethod(STANDARD), searchMethod(FIRST_IMPROVING) {
+constructionMethod(STANDARD), searchMethod(FIRST_IMPROVING), boundNodeLimit(5000), usePresolve(true),
+boundComputed(false), upperBound(1e18), lastBestValue(-1e9) {
     auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
     rng.seed(seed);
 }
 
 GRASP::GRASP(double alpha, int maxIter, int timeLimit, ConstructionMethod cm, SearchMethod sm)
     : alpha(alpha), maxIterations(maxIter), timeLimit(timeLimit),
-    constructionMethod(cm), searchMethod(sm) {
+    constructionMethod(cm), searchMethod(sm), boundNodeLimit(5000), usePresolve(true), boundComputed(false),
+    upperBound(1e18), lastBestValue(-1e9) {
     auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
     rng.seed(seed);
 }
 
 vector<int> GRASP::run(const SetCoverQBF& scqbf) {
+    return solve(scqbf).toVector();
+}
+
+Solution GRASP::solve(const SetCoverQBF& scqbf) {
     // cout << "Iniciando GRASP para MAX-SC-QBF..." << endl;
     cout << "Starting GRASP for MAX-SC-QBF..." << endl;
     cout << "Parameters: alpha=" << alpha << ", maxIter=" << maxIterations << endl;
 
-    vector<int> bestSolution;
-    double bestValue = -1e9;
+    if (!usePresolve) {
+        return search(scqbf, 0.0);
+    }
+
+    Presolve presolve(scqbf);
+    cout << "Presolve: " << presolve.getReduced().getNumSets() << "/" << scqbf.getNumSets() << " sets remain ("
+        << presolve.getNumMandatory() << " mandatory, "
+        << presolve.getNumFixedByObjective() << " fixed by objective, "
+        << presolve.getNumDominated() << " dominated)" << endl;
+
+    return presolve.expand(search(presolve.getReduced(), presolve.getOffset()));
+}
+
+Solution GRASP::search(const SetCoverQBF& scqbf, double offset) {
+    profile = ProfileCounters();
+    Solution bestSolution;
+    lastBestValue = -1e9;
+    upperBound = 1e18;
+    boundComputed = false;
 
     auto startTime = chrono::high_resolution_clock::now();
 
+    if (boundNodeLimit > 0) {
+        UpperBound bounder(scqbf, boundNodeLimit);
+        upperBound = bounder.compute() + offset;
+        boundComputed = true;
+        cout << "Upper bound: " << upperBound << " (" << bounder.getNodesExplored() << " nodes"
+            << (bounder.isProvenOptimal() ? ", optimal" : "") << ")" << endl;
+    }
+
     for (int iter = 0; iter < maxIterations; iter++) {
         auto currentTime = chrono::high_resolution_clock::now();
         auto elapsed = chrono::duration_cast<chrono::seconds>(currentTime - startTime).count();
@@ -38,33 +72,48 @@ vector<int> GRASP::run(const SetCoverQBF& scqbf) {
         }
 
         // Construction Phase
-        vector<int> solution = constructSolution(scqbf);
+        Solution solution = constructSolution(scqbf);
 
         // Local Search Phase
         solution = localSearch(scqbf, solution);
 
         // Evaluate solution
-        double value = scqbf.evaluateSolution(solution);
+        double value = evaluate(scqbf, solution) + offset;
 
         // Update best solution
-        if (value > bestValue) {
-            bestValue = value;
+        if (value > lastBestValue) {
+            lastBestValue = value;
             bestSolution = solution;
             cout << "New best solution found at iteration " << (iter + 1)
-                << " with value: " << bestValue << endl;
+                << " with value: " << lastBestValue << endl;
+
+            if (lastBestValue >= upperBound) {
+                cout << "Best value matches the upper bound, stopping." << endl;
+                break;
+            }
         }
 
         if ((iter + 1) % 100 == 0) {
-            cout << "Iteration " << (iter + 1) << " - Best value: " << bestValue << endl;
+            cout << "Iteration " << (iter + 1) << " - Best value: " << lastBestValue << endl;
         }
     }
 
-    cout << "GRASP finished. Best value found: " << bestValue << endl;
+    cout << "GRASP finished. Best value found: " << lastBestValue;
+    if (boundComputed) {
+        cout << " - Upper bound: " << upperBound << " - Gap: " << getGap() << "%";
+    }
+    cout << endl;
 
     return bestSolution;
 }
 
-vector<int> GRASP::constructSolution(const SetCoverQBF& scqbf) {
+double GRASP::getGap() const {
+    if (!boundComputed || lastBestValue >= upperBound) return 0.0;
+    return 100.0 * (upperBound - lastBestValue) / max(1.0, fabs(upperBound));
+}
+
+Solution GRASP::constructSolution(const SetCoverQBF& scqbf) {
+    PROFILE_TIMER(constructionSeconds);
     switch (constructionMethod) {
     case RANDOM_PLUS_GREEDY:
         return constructRandomPlusGreedy(scqbf);
@@ -75,9 +124,9 @@ vector<int> GRASP::constructSolution(const SetCoverQBF& scqbf) {
     }
 }
 
-vector<int> GRASP::constructStandard(const SetCoverQBF& scqbf) {
+Solution GRASP::constructStandard(const SetCoverQBF& scqbf) {
     int n = scqbf.getNumSets();
-    vector<int> solution(n, 0);
+    Solution solution(n);
     set<int> uncoveredElements = scqbf.getUniverse();
     vector<bool> candidateSet(n, true);
 
@@ -103,7 +152,7 @@ vector<int> GRASP::constructStandard(const SetCoverQBF& scqbf) {
         int selectedIndex = rcl[dist(rng)];
 
         // Add selected set to solution
-        solution[selectedIndex] = 1;
+        solution.set(selectedIndex);
         candidateSet[selectedIndex] = false;
 
         // Update uncovered elements
@@ -113,9 +162,9 @@ vector<int> GRASP::constructStandard(const SetCoverQBF& scqbf) {
     return solution;
 }
 
-vector<int> GRASP::constructRandomPlusGreedy(const SetCoverQBF& scqbf) {
+Solution GRASP::constructRandomPlusGreedy(const SetCoverQBF& scqbf) {
     int n = scqbf.getNumSets();
-    vector<int> solution(n, 0);
+    Solution solution(n);
     set<int> uncoveredElements = scqbf.getUniverse();
     vector<bool> candidateSet(n, true);
 
@@ -123,7 +172,7 @@ vector<int> GRASP::constructRandomPlusGreedy(const SetCoverQBF& scqbf) {
     uniform_real_distribution<double> prob(0.0, 1.0);
     for (int i = 0; i < n; i++) {
         if (prob(rng) < 0.3) { // 30% of chance to select randomly
-            solution[i] = 1;
+            solution.set(i);
             candidateSet[i] = false;
             updateUncoveredElements(scqbf, i, uncoveredElements);
         }
@@ -146,7 +195,7 @@ vector<int> GRASP::constructRandomPlusGreedy(const SetCoverQBF& scqbf) {
 
         if (bestCandidate == -1) break;
 
-        solution[bestCandidate] = 1;
+        solution.set(bestCandidate);
         candidateSet[bestCandidate] = false;
         updateUncoveredElements(scqbf, bestCandidate, uncoveredElements);
     }
@@ -154,9 +203,9 @@ vector<int> GRASP::constructRandomPlusGreedy(const SetCoverQBF& scqbf) {
     return solution;
 }
 
-vector<int> GRASP::constructSampledGreedy(const SetCoverQBF& scqbf) {
+Solution GRASP::constructSampledGreedy(const SetCoverQBF& scqbf) {
     int n = scqbf.getNumSets();
-    vector<int> solution(n, 0);
+    Solution solution(n);
     set<int> uncoveredElements = scqbf.getUniverse();
     vector<bool> candidateSet(n, true);
 
@@ -192,7 +241,7 @@ vector<int> GRASP::constructSampledGreedy(const SetCoverQBF& scqbf) {
         uniform_int_distribution<int> dist(0, rcl.size() - 1);
         int selectedIndex = rcl[dist(rng)];
 
-        solution[selectedIndex] = 1;
+        solution.set(selectedIndex);
         candidateSet[selectedIndex] = false;
         updateUncoveredElements(scqbf, selectedIndex, uncoveredElements);
     }
@@ -200,8 +249,10 @@ vector<int> GRASP::constructSampledGreedy(const SetCoverQBF& scqbf) {
     return solution;
 }
 
-double GRASP::calculateBenefit(const SetCoverQBF& scqbf, const vector<int>& currentSolution,
+double GRASP::calculateBenefit(const SetCoverQBF& scqbf, const Solution& currentSolution,
     int candidate, const set<int>& uncoveredElements) const {
+    PROFILE_COUNT(benefitCalls, 1);
+    PROFILE_TIMER(benefitSeconds);
 
     double benefit = 0.0;
 
@@ -217,16 +268,20 @@ double GRASP::calculateBenefit(const SetCoverQBF& scqbf, const vector<int>& curr
     benefit += newElementsCovered * 100.0;
 
     // Adding objective function contribution
-    benefit += scqbf.getLinearCoeff(candidate); // Linear term
+    benefit += objectiveGain(scqbf, currentSolution, candidate);
+
+    return benefit;
+}
+
+double GRASP::objectiveGain(const SetCoverQBF& scqbf, const Solution& currentSolution, int candidate) {
+    double gain = scqbf.getLinearCoeff(candidate); // Linear term
 
     // Quadratic terms with already selected sets
-    for (int i = 0; i < static_cast<int>(currentSolution.size()); i++) {
-        if (currentSolution[i] == 1) {
-            benefit += scqbf.getQuadraticCoeff(min(i, candidate), max(i, candidate));
-        }
-    }
+    currentSolution.forEachSetBit([&](int i) {
+        gain += scqbf.getQuadraticCoeff(min(i, candidate), max(i, candidate));
+    });
 
-    return benefit;
+    return gain;
 }
 
 vector<int> GRASP::buildRCL(const vector<pair<double, int>>& candidateBenefits) const {
@@ -243,6 +298,10 @@ vector<int> GRASP::buildRCL(const vector<pair<double, int>>& candidateBenefits)
         }
     }
 
+    PROFILE_COUNT(rclBuilds, 1);
+    PROFILE_COUNT(rclSizeTotal, rcl.size());
+    PROFILE_MAX(rclSizeMax, rcl.size());
+
     return rcl;
 }
 
@@ -254,7 +313,20 @@ void GRASP::updateUncoveredElements(const SetCoverQBF& scqbf, int selectedSet,
     }
 }
 
-vector<int> GRASP::localSearch(const SetCoverQBF& scqbf, vector<int> solution) const {
+double GRASP::evaluate(const SetCoverQBF& scqbf, const Solution& solution) const {
+    PROFILE_COUNT(evaluateCalls, 1);
+    PROFILE_TIMER(evaluateSeconds);
+    return scqbf.evaluateSolution(solution);
+}
+
+bool GRASP::feasible(const SetCoverQBF& scqbf, const Solution& solution) const {
+    PROFILE_COUNT(feasibleCalls, 1);
+    PROFILE_TIMER(feasibleSeconds);
+    return scqbf.isFeasible(solution);
+}
+
+Solution GRASP::localSearch(const SetCoverQBF& scqbf, Solution solution) const {
+    PROFILE_TIMER(localSearchSeconds);
     switch (searchMethod) {
     case BEST_IMPROVING:
         return localSearchBestImproving(scqbf, solution);
@@ -263,20 +335,23 @@ vector<int> GRASP::localSearch(const SetCoverQBF& scqbf, vector<int> solution) c
     }
 }
 
-vector<int> GRASP::localSearchFirstImproving(const SetCoverQBF& scqbf, vector<int> solution) const {
+Solution GRASP::localSearchFirstImproving(const SetCoverQBF& scqbf, Solution solution) const {
     bool improved = true;
-    double currentValue = scqbf.evaluateSolution(solution);
+    double currentValue = evaluate(scqbf, solution);
 
     while (improved) {
         improved = false;
 
         // Operator 1: Flip (toggle 0->1 or 1->0)
         for (int i = 0; i < static_cast<int>(solution.size()); i++) {
-            vector<int> neighbor = solution;
-            neighbor[i] = 1 - neighbor[i];
-
-            if (scqbf.isFeasible(neighbor)) {
-                double neighborValue = scqbf.evaluateSolution(neighbor);
+            Solution neighbor = solution;
+            PROFILE_COUNT(neighborsGenerated, 1);
+            neighbor.flip(i);
+
+            if (feasible(scqbf, neighbor)) {
+                PROFILE_COUNT(neighborsFeasible, 1);
+                double neighborValue = evaluate(scqbf, neighbor);
+                PROFILE_COUNT(neighborsImproving, neighborValue > currentValue);
                 if (neighborValue > currentValue) {
                     solution = neighbor;
                     currentValue = neighborValue;
@@ -291,12 +366,16 @@ vector<int> GRASP::localSearchFirstImproving(const SetCoverQBF& scqbf, vector<in
         // Operator 2: Swap (swap states of two sets)
         for (int i = 0; i < static_cast<int>(solution.size()) && !improved; i++) {
             for (int j = i + 1; j < static_cast<int>(solution.size()); j++) {
-                if (solution[i] != solution[j]) {
-                    vector<int> neighbor = solution;
-                    swap(neighbor[i], neighbor[j]);
-
-                    if (scqbf.isFeasible(neighbor)) {
-                        double neighborValue = scqbf.evaluateSolution(neighbor);
+                if (solution.test(i) != solution.test(j)) {
+                    Solution neighbor = solution;
+                    PROFILE_COUNT(neighborsGenerated, 1);
+                    neighbor.flip(i);
+                    neighbor.flip(j);
+
+                    if (feasible(scqbf, neighbor)) {
+                        PROFILE_COUNT(neighborsFeasible, 1);
+                        double neighborValue = evaluate(scqbf, neighbor);
+                        PROFILE_COUNT(neighborsImproving, neighborValue > currentValue);
                         if (neighborValue > currentValue) {
                             solution = neighbor;
                             currentValue = neighborValue;
@@ -312,22 +391,25 @@ vector<int> GRASP::localSearchFirstImproving(const SetCoverQBF& scqbf, vector<in
     return solution;
 }
 
-vector<int> GRASP::localSearchBestImproving(const SetCoverQBF& scqbf, vector<int> solution) const {
+Solution GRASP::localSearchBestImproving(const SetCoverQBF& scqbf, Solution solution) const {
     bool improved = true;
-    double currentValue = scqbf.evaluateSolution(solution);
+    double currentValue = evaluate(scqbf, solution);
 
     while (improved) {
         improved = false;
-        vector<int> bestNeighbor = solution;
+        Solution bestNeighbor = solution;
         double bestValue = currentValue;
 
         // Operator 1: Flip
         for (int i = 0; i < static_cast<int>(solution.size()); i++) {
-            vector<int> neighbor = solution;
-            neighbor[i] = 1 - neighbor[i];
-
-            if (scqbf.isFeasible(neighbor)) {
-                double neighborValue = scqbf.evaluateSolution(neighbor);
+            Solution neighbor = solution;
+            PROFILE_COUNT(neighborsGenerated, 1);
+            neighbor.flip(i);
+
+            if (feasible(scqbf, neighbor)) {
+                PROFILE_COUNT(neighborsFeasible, 1);
+                double neighborValue = evaluate(scqbf, neighbor);
+                PROFILE_COUNT(neighborsImproving, neighborValue > currentValue);
                 if (neighborValue > bestValue) {
                     bestNeighbor = neighbor;
                     bestValue = neighborValue;
@@ -339,12 +421,16 @@ vector<int> GRASP::localSearchBestImproving(const SetCoverQBF& scqbf, vector<int
         // Operator 2: Swap
         for (int i = 0; i < static_cast<int>(solution.size()); i++) {
             for (int j = i + 1; j < static_cast<int>(solution.size()); j++) {
-                if (solution[i] != solution[j]) {
-                    vector<int> neighbor = solution;
-                    swap(neighbor[i], neighbor[j]);
-
-                    if (scqbf.isFeasible(neighbor)) {
-                        double neighborValue = scqbf.evaluateSolution(neighbor);
+                if (solution.test(i) != solution.test(j)) {
+                    Solution neighbor = solution;
+                    PROFILE_COUNT(neighborsGenerated, 1);
+                    neighbor.flip(i);
+                    neighbor.flip(j);
+
+                    if (feasible(scqbf, neighbor)) {
+                        PROFILE_COUNT(neighborsFeasible, 1);
+                        double neighborValue = evaluate(scqbf, neighbor);
+                        PROFILE_COUNT(neighborsImproving, neighborValue > currentValue);
                         if (neighborValue > bestValue) {
                             bestNeighbor = neighbor;
                             bestValue = neighborValue;
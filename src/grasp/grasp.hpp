@@ -2,6 +2,7 @@
 #define GRASP_HPP
 
 #include "../sc-qbf/sc_qbf.hpp"
+#include "profiler.hpp"
 #include <vector>
 #include <random>
 #include <set>
@@ -27,13 +28,20 @@ private:
     int timeLimit; // Time limit in seconds
     ConstructionMethod constructionMethod;
     SearchMethod searchMethod;
+    int boundNodeLimit; // Branch-and-bound nodes for the upper bound (0 disables it)
+    bool usePresolve; // Search the instance reduced by Presolve
+    bool boundComputed; // Whether the last run computed upperBound
+    double upperBound; // Proven upper bound of the last run
+    double lastBestValue; // Best value of the last run
     mutable mt19937 rng; // Random number generator
+    mutable ProfileCounters profile; // Hot-path counters of the last run (GRASP_PROFILE builds)
 
 public:
     GRASP();
     GRASP(double alpha, int maxIter, int timeLimit, ConstructionMethod cm = STANDARD, SearchMethod sm = FIRST_IMPROVING);
 
-    vector<int> run(const SetCoverQBF& scqbf);
+    Solution solve(const SetCoverQBF& scqbf);
+    vector<int> run(const SetCoverQBF& scqbf); // Adapter returning a 0/1 array
 
     // Setters
     void setAlpha(double a) { alpha = a; }
@@ -41,6 +49,9 @@ public:
     void setTimeLimit(int timeLimit) { this->timeLimit = timeLimit; }
     void setConstructionMethod(ConstructionMethod cm) { constructionMethod = cm; }
     void setSearchMethod(SearchMethod sm) { searchMethod = sm; }
+    void setBoundNodeLimit(int limit) { boundNodeLimit = limit; }
+    void setUsePresolve(bool use) { usePresolve = use; }
+    void setSeed(unsigned int seed) { rng.seed(seed); }
 
     // Getters
     double getAlpha() const { return alpha; }
@@ -48,21 +59,34 @@ public:
     int getTimeLimit() const { return timeLimit; }
     ConstructionMethod getConstructionMethod() const { return constructionMethod; }
     SearchMethod getSearchMethod() const { return searchMethod; }
+    int getBoundNodeLimit() const { return boundNodeLimit; }
+    bool getUsePresolve() const { return usePresolve; }
+    bool hasUpperBound() const { return boundComputed; }
+    double getUpperBound() const { return upperBound; }
+    double getGap() const; // Relative optimality gap (%) of the last run, if hasUpperBound()
+    const ProfileCounters& getProfile() const { return profile; }
+
+    // Objective change of adding candidate (not in currentSolution): linear term plus
+    // quadratic terms with the selected sets. This is the objective part of calculateBenefit.
+    static double objectiveGain(const SetCoverQBF& scqbf, const Solution& currentSolution, int candidate);
 
 private:
-    vector<int> constructSolution(const SetCoverQBF& scqbf);
-    vector<int> constructStandard(const SetCoverQBF& scqbf);
-    vector<int> constructRandomPlusGreedy(const SetCoverQBF& scqbf);
-    vector<int> constructSampledGreedy(const SetCoverQBF& scqbf);
+    Solution search(const SetCoverQBF& scqbf, double offset);
+    Solution constructSolution(const SetCoverQBF& scqbf);
+    Solution constructStandard(const SetCoverQBF& scqbf);
+    Solution constructRandomPlusGreedy(const SetCoverQBF& scqbf);
+    Solution constructSampledGreedy(const SetCoverQBF& scqbf);
 
-    double calculateBenefit(const SetCoverQBF& scqbf, const vector<int>& currentSolution,
+    double calculateBenefit(const SetCoverQBF& scqbf, const Solution& currentSolution,
         int candidate, const set<int>& uncoveredElements) const;
     vector<int> buildRCL(const vector<pair<double, int>>& candidateBenefits) const;
     void updateUncoveredElements(const SetCoverQBF& scqbf, int selectedSet,
         set<int>& uncoveredElements) const;
-    vector<int> localSearch(const SetCoverQBF& scqbf, vector<int> solution) const;
-    vector<int> localSearchFirstImproving(const SetCoverQBF& scqbf, vector<int> solution) const;
-    vector<int> localSearchBestImproving(const SetCoverQBF& scqbf, vector<int> solution) const;
+    double evaluate(const SetCoverQBF& scqbf, const Solution& solution) const;
+    bool feasible(const SetCoverQBF& scqbf, const Solution& solution) const;
+    Solution localSearch(const SetCoverQBF& scqbf, Solution solution) const;
+    Solution localSearchFirstImproving(const SetCoverQBF& scqbf, Solution solution) const;
+    Solution localSearchBestImproving(const SetCoverQBF& scqbf, Solution solution) const;
 };
 
 #endif
\ No newline at end of file
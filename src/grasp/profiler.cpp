@@ -0,0 +1,51 @@
+#include "profiler.hpp"
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+string ProfileCounters::csvHeader() {
+    return "Benefit_Calls,Evaluate_Calls,Feasible_Calls,Neighbors,Feasible_Neighbors,Improving_Neighbors,"
+        "RCL_Builds,RCL_Avg,RCL_Max,Benefit_Seconds,Evaluate_Seconds,Feasible_Seconds,Construction_Seconds,"
+        "LocalSearch_Seconds";
+}
+
+string ProfileCounters::toCsv() const {
+    stringstream ss;
+    ss << benefitCalls << "," << evaluateCalls << "," << feasibleCalls << ","
+        << neighborsGenerated << "," << neighborsFeasible << "," << neighborsImproving << ","
+        << rclBuilds << "," << fixed << setprecision(2) << averageRCLSize() << "," << rclSizeMax << ","
+        << setprecision(3) << benefitSeconds << "," << evaluateSeconds << "," << feasibleSeconds << ","
+        << constructionSeconds << "," << localSearchSeconds;
+    return ss.str();
+}
+
+bool ProfileCounters::fromCsv(const vector<string>& fields, size_t first) {
+    if (fields.size() < first + CSV_COLUMNS) return false;
+    benefitCalls = stoll(fields[first]);
+    evaluateCalls = stoll(fields[first + 1]);
+    feasibleCalls = stoll(fields[first + 2]);
+    neighborsGenerated = stoll(fields[first + 3]);
+    neighborsFeasible = stoll(fields[first + 4]);
+    neighborsImproving = stoll(fields[first + 5]);
+    rclBuilds = stoll(fields[first + 6]);
+    rclSizeTotal = llround(stod(fields[first + 7]) * rclBuilds);
+    rclSizeMax = stoll(fields[first + 8]);
+    benefitSeconds = stod(fields[first + 9]);
+    evaluateSeconds = stod(fields[first + 10]);
+    feasibleSeconds = stod(fields[first + 11]);
+    constructionSeconds = stod(fields[first + 12]);
+    localSearchSeconds = stod(fields[first + 13]);
+    return true;
+}
+
+string ProfileCounters::toLog() const {
+    stringstream ss;
+    ss << "  calls: benefit=" << benefitCalls << " (" << benefitSeconds << "s)"
+        << " evaluate=" << evaluateCalls << " (" << evaluateSeconds << "s)"
+        << " feasible=" << feasibleCalls << " (" << feasibleSeconds << "s)\n"
+        << "  neighbors: generated=" << neighborsGenerated << " feasible=" << neighborsFeasible
+        << " improving=" << neighborsImproving << "\n"
+        << "  rcl: builds=" << rclBuilds << " avg=" << averageRCLSize() << " max=" << rclSizeMax << "\n"
+        << "  phases: construction=" << constructionSeconds << "s local_search=" << localSearchSeconds << "s";
+    return ss.str();
+}
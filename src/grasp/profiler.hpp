@@ -0,0 +1,66 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Hot-path counters and timers of one GRASP run. Each GRASP object is driven by a single
+// thread, so the counters are plain fields. Compiled in only with -DGRASP_PROFILE (make profile).
+struct ProfileCounters {
+#ifdef GRASP_PROFILE
+    static constexpr bool ENABLED = true;
+#else
+    static constexpr bool ENABLED = false;
+#endif
+
+    long long benefitCalls = 0;
+    long long evaluateCalls = 0;
+    long long feasibleCalls = 0;
+    long long neighborsGenerated = 0;
+    long long neighborsFeasible = 0;
+    long long neighborsImproving = 0;
+    long long rclBuilds = 0;
+    long long rclSizeTotal = 0;
+    long long rclSizeMax = 0;
+    double benefitSeconds = 0.0;
+    double evaluateSeconds = 0.0;
+    double feasibleSeconds = 0.0;
+    double constructionSeconds = 0.0;
+    double localSearchSeconds = 0.0;
+
+    double averageRCLSize() const { return rclBuilds ? static_cast<double>(rclSizeTotal) / rclBuilds : 0.0; }
+
+    static const size_t CSV_COLUMNS = 14;
+
+    static string csvHeader();
+    string toCsv() const;
+    // Reads the csvHeader() columns starting at fields[first]
+    bool fromCsv(const vector<string>& fields, size_t first);
+    string toLog() const;
+};
+
+// Adds the lifetime of the enclosing scope to a seconds counter
+class ScopedTimer {
+private:
+    double& target;
+    chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedTimer(double& target) : target(target), start(chrono::steady_clock::now()) {}
+    ~ScopedTimer() { target += chrono::duration<double>(chrono::steady_clock::now() - start).count(); }
+};
+
+#ifdef GRASP_PROFILE
+#define PROFILE_COUNT(field, n) (profile.field += (n))
+#define PROFILE_MAX(field, value) (profile.field = max(profile.field, static_cast<long long>(value)))
+#define PROFILE_TIMER(field) ScopedTimer profileTimer(profile.field)
+#else
+#define PROFILE_COUNT(field, n) ((void)0)
+#define PROFILE_MAX(field, value) ((void)0)
+#define PROFILE_TIMER(field) ((void)0)
+#endif
+
+#endif
@@ -10,68 +10,126 @@
 #include <iomanip>
 #include <sstream>
 #include <map>
+#include <cstdio>
 #include "sc-qbf/sc_qbf.hpp"
 #include "grasp/grasp.hpp"
+#include "verify/differential.hpp"
 
 std::mutex results_mutex;
 
+const std::vector<std::tuple<std::string, GRASP::ConstructionMethod, GRASP::SearchMethod, double>> configs = {
+    {"STANDARD", GRASP::STANDARD, GRASP::FIRST_IMPROVING, 0.1},
+    {"STANDARD+ALPHA", GRASP::STANDARD, GRASP::FIRST_IMPROVING, 0.3},
+    {"STANDARD+BEST", GRASP::STANDARD, GRASP::BEST_IMPROVING, 0.1},
+    {"STANDARD+HC1", GRASP::RANDOM_PLUS_GREEDY, GRASP::FIRST_IMPROVING, 0.1},
+    {"STANDARD+HC2", GRASP::SAMPLED_GREEDY, GRASP::FIRST_IMPROVING, 0.1}
+};
+
+// One (instance, config, seed) run of a sharded sweep
+struct WorkItem {
+    size_t index;
+    std::string instance;
+    size_t config;
+    unsigned int seed;
+};
+
 struct ExperimentResult {
     std::string instance;
     std::string config;
     double value;
     int time_seconds;
     bool feasible;
+    double upper_bound;
+    double gap;
+    bool has_bound; // upper_bound and gap are only meaningful when the bound was computed
+    size_t index;
+    unsigned int seed;
+    bool failed; // runSingleConfig caught an exception; the other fields are not meaningful
+    ProfileCounters profile;
 };
 
 std::vector<ExperimentResult> all_results;
 
+std::string formatBound(const ExperimentResult& r) {
+    if (!r.has_bound) return "n/a";
+    std::ostringstream ss;
+    ss << r.upper_bound;
+    return ss.str();
+}
+
+std::string formatGap(const ExperimentResult& r, bool percent = true) {
+    if (!r.has_bound) return "n/a";
+    std::ostringstream ss;
+    ss << r.gap << (percent ? "%" : "");
+    return ss.str();
+}
+
 void writeResults(const std::string& filename) {
     std::ofstream file(filename);
-    file << "Instance,Configuration,Value,Time_Seconds,Feasible\n";
+    file << "Instance,Configuration,Value,Time_Seconds,Feasible,Seed,Upper_Bound,Gap,"
+         << ProfileCounters::csvHeader() << "\n";
     for (const auto& r : all_results) {
         file << r.instance << "," << r.config << ","
              << std::fixed << std::setprecision(2) << r.value << ","
              << r.time_seconds << ","
-             << (r.feasible ? "Yes" : "No") << "\n";
+             << (r.feasible ? "Yes" : "No") << ","
+             << r.seed << "," << formatBound(r) << "," << formatGap(r, false) << ","
+             << r.profile.toCsv() << "\n";
     }
 }
 
 ExperimentResult runSingleConfig(const std::string& instPath, const std::string& instName,
                                  const std::string& cfgName, GRASP::ConstructionMethod cm,
-                                 GRASP::SearchMethod sm, double alpha) {
-    ExperimentResult r{instName, cfgName, -1, -1, false};
+                                 GRASP::SearchMethod sm, double alpha, unsigned int seed = 0) {
+    ExperimentResult r{instName, cfgName, -1, -1, false, -1, -1, false, 0, seed, false, {}};
     try {
         SetCoverQBF scqbf(instPath);
         GRASP grasp(alpha, 10000, 1800, cm, sm);
+        if (seed != 0) grasp.setSeed(seed);
 
         auto start = std::chrono::high_resolution_clock::now();
-        auto sol = grasp.run(scqbf);
+        Solution sol = grasp.solve(scqbf);
         auto end = std::chrono::high_resolution_clock::now();
 
         r.value = scqbf.evaluateSolution(sol);
         r.feasible = scqbf.isFeasible(sol);
+        r.has_bound = grasp.hasUpperBound();
+        r.upper_bound = grasp.getUpperBound();
+        r.gap = grasp.getGap();
+        r.profile = grasp.getProfile();
         r.time_seconds = std::chrono::duration_cast<std::chrono::seconds>(end - start).count();
     } catch (const std::exception& e) {
         std::cerr << "Error in " << instName << ": " << e.what() << std::endl;
+        r.failed = true;
     }
     return r;
 }
 
-void runInstance(const std::string& instPath, const std::string& instName) {
-    std::vector<std::tuple<std::string, GRASP::ConstructionMethod, GRASP::SearchMethod, double>> configs = {
-        {"STANDARD", GRASP::STANDARD, GRASP::FIRST_IMPROVING, 0.1},
-        {"STANDARD+ALPHA", GRASP::STANDARD, GRASP::FIRST_IMPROVING, 0.3},
-        {"STANDARD+BEST", GRASP::STANDARD, GRASP::BEST_IMPROVING, 0.1},
-        {"STANDARD+HC1", GRASP::RANDOM_PLUS_GREEDY, GRASP::FIRST_IMPROVING, 0.1},
-        {"STANDARD+HC2", GRASP::SAMPLED_GREEDY, GRASP::FIRST_IMPROVING, 0.1}
-    };
-
+void writeInstanceLog(const std::string& instName, const std::vector<ExperimentResult>& results) {
     std::string baseName = instName;
     size_t lastindex = baseName.find_last_of(".");
     if (lastindex != std::string::npos) {
         baseName = baseName.substr(0, lastindex);
     }
 
+    std::ofstream log("logs/" + baseName + ".log");
+    log << "Running instance: " << instName << "\n";
+    for (auto& r : results) {
+        log << r.config;
+        if (r.seed != 0) log << " Seed=" << r.seed;
+        log << " -> Value=" << r.value
+            << " Time=" << r.time_seconds << "s"
+            << " Feasible=" << (r.feasible ? "Yes" : "No")
+            << " Bound=" << formatBound(r)
+            << " Gap=" << formatGap(r) << "\n";
+        if (ProfileCounters::ENABLED) {
+            log << r.profile.toLog() << "\n";
+        }
+    }
+    log.close();
+}
+
+void runInstance(const std::string& instPath, const std::string& instName) {
     std::vector<std::future<ExperimentResult>> futures;
     for (auto& [cfgName, cm, sm, alpha] : configs) {
         futures.push_back(std::async(std::launch::async, [&, cfgName, cm, sm, alpha]() {
@@ -84,14 +142,7 @@ void runInstance(const std::string& instPath, const std::string& instName) {
         local_results.push_back(f.get());
     }
 
-    std::ofstream log("logs/" + baseName + ".log");
-    log << "Running instance: " << instName << "\n";
-    for (auto& r : local_results) {
-        log << r.config << " -> Value=" << r.value
-            << " Time=" << r.time_seconds << "s"
-            << " Feasible=" << (r.feasible ? "Yes" : "No") << "\n";
-    }
-    log.close();
+    writeInstanceLog(instName, local_results);
 
     {
         std::lock_guard<std::mutex> lock(results_mutex);
@@ -127,7 +178,194 @@ std::vector<std::string> setupInstances(const std::string& path) {
     return insts;
 }
 
-int main() {
+// Deterministic (instance, config, seed) list shared by every shard
+std::vector<WorkItem> buildWorkList(const std::vector<std::string>& instances, unsigned int numSeeds) {
+    std::vector<WorkItem> work;
+    for (const auto& inst : instances) {
+        for (size_t c = 0; c < configs.size(); c++) {
+            for (unsigned int seed = 1; seed <= numSeeds; seed++) {
+                work.push_back({work.size(), inst, c, seed});
+            }
+        }
+    }
+    return work;
+}
+
+// First line of every shard file, so merge can check the whole work list is present
+struct ShardInfo {
+    unsigned int shard;
+    unsigned int numShards;
+    unsigned int numSeeds;
+    size_t total;
+};
+
+const std::string SHARD_HEADER = "Index,Instance,Configuration,Seed,Value,Time_Seconds,Feasible,Upper_Bound,Gap,"
+    + ProfileCounters::csvHeader();
+
+void writeShardRow(std::ofstream& file, const ExperimentResult& r) {
+    file << r.index << "," << r.instance << "," << r.config << "," << r.seed << ","
+         << std::fixed << std::setprecision(2) << r.value << ","
+         << r.time_seconds << ","
+         << (r.feasible ? "Yes" : "No") << ","
+         << formatBound(r) << "," << formatGap(r, false) << ","
+         << r.profile.toCsv() << "\n";
+    file.flush();
+}
+
+// Runs every work item with index % numShards == shard and writes results/shard-<k>-of-<n>.csv.
+// Failed runs are left out of the file (merge then reports them missing) and make the shard exit 1.
+int runShard(unsigned int shard, unsigned int numShards, const std::vector<std::string>& instances,
+             unsigned int numSeeds) {
+    std::vector<WorkItem> work = buildWorkList(instances, numSeeds);
+
+    std::filesystem::create_directory("results");
+    std::string filename = "results/shard-" + std::to_string(shard) + "-of-" + std::to_string(numShards) + ".csv";
+    std::ofstream file(filename);
+    file << "# shard=" << shard << " shards=" << numShards << " seeds=" << numSeeds
+         << " total=" << work.size() << "\n";
+    file << SHARD_HEADER << "\n";
+
+    size_t count = 0, failed = 0;
+    for (size_t i = shard; i < work.size(); i += numShards) {
+        const WorkItem& item = work[i];
+        auto& [cfgName, cm, sm, alpha] = configs[item.config];
+        ExperimentResult r = runSingleConfig("instances/" + item.instance, item.instance,
+                                             cfgName, cm, sm, alpha, item.seed);
+        r.index = item.index;
+        if (r.failed) {
+            std::cerr << "Work item " << item.index << " (" << item.instance << ", " << cfgName
+                      << ", seed " << item.seed << ") failed" << std::endl;
+            failed++;
+            continue;
+        }
+        writeShardRow(file, r);
+        count++;
+    }
+
+    std::cout << "Shard " << shard << "/" << numShards << ": " << count << " of " << work.size()
+              << " runs saved in " << filename;
+    if (failed > 0) std::cout << ", " << failed << " failed";
+    std::cout << "\n";
+    return failed > 0 ? 1 : 0;
+}
+
+bool readShardFile(const std::string& filename, ShardInfo& info, std::vector<ExperimentResult>& results) {
+    std::ifstream file(filename);
+    std::string line;
+    bool valid = file.is_open() && std::getline(file, line)
+        && std::sscanf(line.c_str(), "# shard=%u shards=%u seeds=%u total=%zu",
+                       &info.shard, &info.numShards, &info.numSeeds, &info.total) == 4
+        && std::getline(file, line) && line == SHARD_HEADER;
+    if (!valid) {
+        std::cerr << "Invalid shard file: " << filename << std::endl;
+        return false;
+    }
+
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ',')) fields.push_back(field);
+        if (fields.size() != 9 + ProfileCounters::CSV_COLUMNS) {
+            std::cerr << "Invalid row in " << filename << ": " << line << std::endl;
+            return false;
+        }
+
+        ExperimentResult r{};
+        r.index = std::stoul(fields[0]);
+        r.instance = fields[1];
+        r.config = fields[2];
+        r.seed = std::stoul(fields[3]);
+        r.value = std::stod(fields[4]);
+        r.time_seconds = std::stoi(fields[5]);
+        r.feasible = fields[6] == "Yes";
+        r.has_bound = fields[7] != "n/a";
+        r.upper_bound = r.has_bound ? std::stod(fields[7]) : -1;
+        r.gap = r.has_bound ? std::stod(fields[8]) : -1;
+        r.profile.fromCsv(fields, 9);
+        results.push_back(r);
+    }
+    return true;
+}
+
+// Combines shard files into grasp_results.csv and the per-instance logs, in work-list order
+int mergeShards(const std::vector<std::string>& files) {
+    if (files.empty()) {
+        std::cerr << "No shard files to merge" << std::endl;
+        return 1;
+    }
+
+    std::vector<ExperimentResult> merged;
+    ShardInfo first{};
+    for (size_t i = 0; i < files.size(); i++) {
+        ShardInfo info{};
+        if (!readShardFile(files[i], info, merged)) return 1;
+        if (i == 0) {
+            first = info;
+        } else if (info.numShards != first.numShards || info.numSeeds != first.numSeeds
+                   || info.total != first.total) {
+            std::cerr << "Shard file " << files[i] << " belongs to a different sweep than " << files[0]
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    std::sort(merged.begin(), merged.end(), [](const ExperimentResult& a, const ExperimentResult& b) {
+        return a.index < b.index;
+    });
+    auto duplicate = std::adjacent_find(merged.begin(), merged.end(),
+        [](const ExperimentResult& a, const ExperimentResult& b) { return a.index == b.index; });
+    if (duplicate != merged.end()) {
+        std::cerr << "Duplicate work item " << duplicate->index << " in shard files" << std::endl;
+        return 1;
+    }
+
+    std::vector<size_t> missing;
+    size_t next = 0;
+    for (const auto& r : merged) {
+        if (r.index >= first.total) {
+            std::cerr << "Work item " << r.index << " outside the work list of " << first.total << std::endl;
+            return 1;
+        }
+        while (next < r.index) missing.push_back(next++);
+        next = r.index + 1;
+    }
+    while (next < first.total) missing.push_back(next++);
+    if (!missing.empty()) {
+        std::cerr << "Missing " << missing.size() << " of " << first.total << " work items:";
+        for (size_t index : missing) std::cerr << " " << index;
+        std::cerr << std::endl;
+        return 1;
+    }
+
+    all_results = merged;
+    writeResults("grasp_results.csv");
+
+    std::filesystem::create_directory("logs");
+    std::map<std::string, std::vector<ExperimentResult>> byInstance;
+    for (const auto& r : merged) byInstance[r.instance].push_back(r);
+    for (const auto& [instName, results] : byInstance) writeInstanceLog(instName, results);
+
+    std::cout << "Merged " << merged.size() << " runs from " << files.size()
+              << " shard files into grasp_results.csv\n";
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--verify") {
+        std::vector<std::string> paths(argv + 2, argv + argc);
+        if (paths.empty()) {
+            paths = {"example/ex-00.txt", "example/ex-01.txt", "example/ex-06.txt"};
+        }
+        DifferentialTester tester;
+        return tester.runAll(paths) ? 0 : 1;
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--merge") {
+        return mergeShards(std::vector<std::string>(argv + 2, argv + argc));
+    }
+
     std::filesystem::create_directory("logs");
     std::string path = "instances/";
 
@@ -137,6 +375,20 @@ int main() {
         return 1;
     }
 
+    if (argc > 1 && std::string(argv[1]) == "--shard") {
+        unsigned int shard = 0, numShards = 0, numSeeds = 1;
+        char slash = 0;
+        std::stringstream spec(argc > 2 ? argv[2] : "");
+        if (!(spec >> shard >> slash >> numShards) || slash != '/' || numShards == 0 || shard >= numShards) {
+            std::cerr << "Usage: " << argv[0] << " --shard K/N [--seeds S]" << std::endl;
+            return 1;
+        }
+        if (argc > 4 && std::string(argv[3]) == "--seeds") {
+            numSeeds = std::max(1, std::atoi(argv[4]));
+        }
+        return runShard(shard, numShards, instances, numSeeds);
+    }
+
     std::cout << "Running " << instances.size() << " instances...\n";
     runAllInstances(instances);
 
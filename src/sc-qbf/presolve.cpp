@@ -0,0 +1,169 @@
+#include "presolve.hpp"
+#include <algorithm>
+
+Presolve::Presolve(const SetCoverQBF& scqbf) : m(scqbf.getNumSets()), state(m, FREE) {
+    vector<double> linear(m, 0.0);
+    vector<vector<double>> Q(m, vector<double>(m, 0.0));
+    for (int i = 0; i < m; i++) {
+        linear[i] = scqbf.getLinearCoeff(i);
+        for (int j = i + 1; j < m; j++) {
+            Q[i][j] = Q[j][i] = scqbf.getQuadraticCoeff(i, j);
+        }
+    }
+
+    set<int> universe = scqbf.getUniverse();
+    int maxElement = universe.empty() ? 0 : max(0, *universe.rbegin());
+    vector<vector<int>> coverers(maxElement + 1);
+    for (int i = 0; i < m; i++) {
+        for (int element : scqbf.getSet(i)) {
+            coverers[element].push_back(i);
+        }
+    }
+
+    vector<char> covered(maxElement + 1, 0);
+    auto fixToOne = [&](int i) {
+        state[i] = 1;
+        for (int element : scqbf.getSet(i)) covered[element] = 1;
+    };
+
+    // Elements of set i not yet covered by the sets fixed to 1 (sorted)
+    auto residual = [&](int i) {
+        vector<int> elements;
+        for (int element : scqbf.getSet(i)) {
+            if (!covered[element]) elements.push_back(element);
+        }
+        sort(elements.begin(), elements.end());
+        elements.erase(unique(elements.begin(), elements.end()), elements.end());
+        return elements;
+    };
+
+    // Contribution of set i with the sets fixed to 1
+    auto fixedPart = [&](int i) {
+        double value = linear[i];
+        for (int j = 0; j < m; j++) {
+            if (state[j] == 1) value += Q[i][j];
+        }
+        return value;
+    };
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        // Mandatory sets: the only remaining coverer of some element
+        for (int element : universe) {
+            if (covered[element]) continue;
+            int freeCount = 0;
+            int lastFree = -1;
+            for (int i : coverers[element]) {
+                if (state[i] == FREE) {
+                    freeCount++;
+                    lastFree = i;
+                }
+            }
+            if (freeCount == 1) {
+                fixToOne(lastFree);
+                numMandatory++;
+                changed = true;
+            }
+        }
+
+        // Sets whose contribution has the same sign for every completion. Adding a set never
+        // breaks coverage; removing one is only safe when it covers nothing still needed.
+        for (int i = 0; i < m; i++) {
+            if (state[i] != FREE) continue;
+            double base = fixedPart(i);
+            double low = base, high = base;
+            for (int j = 0; j < m; j++) {
+                if (j == i || state[j] != FREE) continue;
+                low += min(0.0, Q[i][j]);
+                high += max(0.0, Q[i][j]);
+            }
+
+            if (low >= 0.0) {
+                fixToOne(i);
+                numFixedByObjective++;
+                changed = true;
+            } else if (high <= 0.0 && residual(i).empty()) {
+                state[i] = 0;
+                numFixedByObjective++;
+                changed = true;
+            }
+        }
+
+        // Dominated sets: j can be fixed to 0 if some free k covers all of its remaining
+        // elements and, in any solution containing j, either replacing j by k (k absent)
+        // or dropping j (k present) does not decrease the objective
+        for (int j = 0; j < m; j++) {
+            if (state[j] != FREE) continue;
+            vector<int> residualJ = residual(j);
+
+            double baseJ = fixedPart(j);
+            double highJ = baseJ;
+            for (int i = 0; i < m; i++) {
+                if (i != j && state[i] == FREE) highJ += max(0.0, Q[j][i]);
+            }
+
+            for (int k = 0; k < m; k++) {
+                if (k == j || state[k] != FREE) continue;
+
+                // Dropping j while k is selected
+                if (highJ - max(0.0, Q[j][k]) + Q[j][k] > 0.0) continue;
+
+                vector<int> residualK = residual(k);
+                if (!includes(residualK.begin(), residualK.end(), residualJ.begin(), residualJ.end())) continue;
+
+                // Replacing j by k
+                double swapGain = fixedPart(k) - baseJ;
+                for (int i = 0; i < m; i++) {
+                    if (i == j || i == k || state[i] != FREE) continue;
+                    swapGain += min(0.0, Q[k][i] - Q[j][i]);
+                }
+                if (swapGain < 0.0) continue;
+
+                state[j] = 0;
+                numDominated++;
+                changed = true;
+                break;
+            }
+        }
+    }
+
+    // Reduced instance over the free sets: coefficients with the fixed sets are folded
+    // into the linear terms, and elements already covered are dropped
+    for (int i = 0; i < m; i++) {
+        if (state[i] == FREE) mapping.push_back(i);
+    }
+    int n = static_cast<int>(mapping.size());
+
+    vector<vector<int>> sets(n), A(n);
+    for (int a = 0; a < n; a++) {
+        int i = mapping[a];
+        sets[a] = residual(i);
+        A[a].push_back(static_cast<int>(fixedPart(i)));
+        for (int b = a + 1; b < n; b++) {
+            A[a].push_back(static_cast<int>(Q[i][mapping[b]]));
+        }
+    }
+
+    offset = 0.0;
+    for (int i = 0; i < m; i++) {
+        if (state[i] != 1) continue;
+        offset += linear[i];
+        for (int j = i + 1; j < m; j++) {
+            if (state[j] == 1) offset += Q[i][j];
+        }
+    }
+
+    reduced = SetCoverQBF(sets, A);
+    reduced.path = scqbf.path;
+}
+
+Solution Presolve::expand(const Solution& reducedSolution) const {
+    Solution solution(m);
+    for (int i = 0; i < m; i++) {
+        if (state[i] == 1) solution.set(i);
+    }
+    reducedSolution.forEachSetBit([&](int a) { solution.set(mapping[a]); });
+    return solution;
+}
@@ -0,0 +1,41 @@
+#ifndef PRESOLVE_HPP
+#define PRESOLVE_HPP
+
+#include "sc_qbf.hpp"
+#include <vector>
+
+using namespace std;
+
+// Reduction pass run before search: fixes mandatory sets, fixes sets whose objective
+// contribution has a known sign, removes dominated sets and builds the reduced instance
+class Presolve {
+public:
+    static constexpr signed char FREE = -1;
+
+private:
+    int m; // Number of sets of the original instance
+    vector<signed char> state; // Fixed value of each original set, or FREE
+    vector<int> mapping; // Reduced index -> original index
+    double offset = 0.0; // Objective value of the sets fixed to 1
+    SetCoverQBF reduced;
+
+    int numMandatory = 0;
+    int numFixedByObjective = 0;
+    int numDominated = 0;
+
+public:
+    Presolve(const SetCoverQBF& scqbf);
+
+    const SetCoverQBF& getReduced() const { return reduced; }
+    const vector<int>& getMapping() const { return mapping; }
+    double getOffset() const { return offset; }
+
+    // Maps a solution of the reduced instance back to the original one
+    Solution expand(const Solution& reducedSolution) const;
+
+    int getNumMandatory() const { return numMandatory; }
+    int getNumFixedByObjective() const { return numFixedByObjective; }
+    int getNumDominated() const { return numDominated; }
+};
+
+#endif
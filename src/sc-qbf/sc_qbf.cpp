@@ -2,11 +2,17 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <algorithm>
 
 SetCoverQBF::SetCoverQBF(string path) : path(path) {
     readFile();
 }
 
+SetCoverQBF::SetCoverQBF(const vector<vector<int>>& sets, const vector<vector<int>>& A)
+    : m(static_cast<int>(sets.size())), variables(sets.size(), 0), A(A), sets(sets) {
+    buildUniverse();
+}
+
 void SetCoverQBF::readFile() {
     ifstream file(path);
     string line;
@@ -63,61 +69,52 @@ void SetCoverQBF::readFile() {
     }
 
     file.close();
+
+    buildUniverse();
 }
 
-double SetCoverQBF::evaluateSolution(const vector<int>& solution) const {
+void SetCoverQBF::buildUniverse() {
+    set<int> elements;
+    for (const auto& subset : this->sets) {
+        elements.insert(subset.begin(), subset.end());
+    }
+    this->universe.assign(elements.begin(), elements.end());
+    this->maxElement = this->universe.empty() ? 0 : max(0, this->universe.back());
+}
+
+double SetCoverQBF::evaluateSolution(const Solution& solution) const {
     double totalValue = 0.0;
 
-    // Linear terms: first element of each row in A
-    for (int i = 0; i < this->m; i++) {
-        if (solution[i] == 1) {
-            totalValue += this->A[i][0]; // First element of row 1 (linear term)
-        }
-    }
+    solution.forEachSetBit([&](int i) {
+        // Linear term: first element of row i
+        totalValue += this->A[i][0];
 
-    // Quadratic terms: upper triangular part of A
-    for (int i = 0; i < this->m; i++) {
-        if (solution[i] == 1) {
-            // For each row i, we start from index 1 (which corresponds to element A[i][i+1])
-            for (int j = i + 1; j < this->m; j++) {
-                if (solution[j] == 1) {
-                    // The coefficient A[i][j] is stored in A[i][j-i]
-                    // That is, A[i][1] corresponds to A[i][i+1], A[i][2] to A[i][i+2], etc.
-                    int coeff_index = j - i;
-                    if (coeff_index < static_cast<int>(this->A[i].size())) {
-                        totalValue += this->A[i][coeff_index];
-                    }
-                }
-            }
+        // Quadratic terms: A[i][j] is stored in A[i][j-i] for each selected j > i
+        int rowSize = static_cast<int>(this->A[i].size());
+        for (int j = solution.nextSetBit(i + 1); j < this->m; j = solution.nextSetBit(j + 1)) {
+            int coeff_index = j - i;
+            if (coeff_index >= rowSize) break;
+            totalValue += this->A[i][coeff_index];
         }
-    }
+    });
 
     return totalValue;
 }
 
-bool SetCoverQBF::isFeasible(const vector<int>& solution) const {
-    set<int> universe;
-    for (const auto& subset : this->sets) {
-        for (int element : subset) {
-            universe.insert(element);
-        }
-    }
+double SetCoverQBF::evaluateSolution(const vector<int>& solution) const {
+    return evaluateSolution(Solution(solution));
+}
 
-    for (int element : universe) {
-        bool covered = false;
-        for (int i = 0; i < this->m; i++) {
-            if (solution[i] == 1) {
-                for (int elem : this->sets[i]) {
-                    if (elem == element) {
-                        covered = true;
-                        break;
-                    }
-                }
-                if (covered) break;
-            }
+bool SetCoverQBF::isFeasible(const Solution& solution) const {
+    vector<char> covered(this->maxElement + 1, 0);
+    solution.forEachSetBit([&](int i) {
+        for (int elem : this->sets[i]) {
+            covered[elem] = 1;
         }
+    });
 
-        if (!covered) {
+    for (int element : this->universe) {
+        if (!covered[element]) {
             return false;
         }
     }
@@ -125,14 +122,12 @@ bool SetCoverQBF::isFeasible(const vector<int>& solution) const {
     return true;
 }
 
+bool SetCoverQBF::isFeasible(const vector<int>& solution) const {
+    return isFeasible(Solution(solution));
+}
+
 set<int> SetCoverQBF::getUniverse() const {
-    set<int> universe;
-    for (const auto& subset : this->sets) {
-        for (int element : subset) {
-            universe.insert(element);
-        }
-    }
-    return universe;
+    return set<int>(this->universe.begin(), this->universe.end());
 }
 
 int SetCoverQBF::getNumSets() const { return m; }
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <set>
+#include "solution.hpp"
 
 using namespace std;
 
@@ -15,10 +16,17 @@ public:
     vector<vector<int>> A;// Triangular matrix of coefficients
     vector<vector<int>> sets; // Sets of elements
 
+    SetCoverQBF() = default;
     SetCoverQBF(string path);
+    SetCoverQBF(const vector<vector<int>>& sets, const vector<vector<int>>& A);
 
+    double evaluateSolution(const Solution& solution) const;
+    bool isFeasible(const Solution& solution) const;
+
+    // Adapters for 0/1 arrays
     double evaluateSolution(const vector<int>& solution) const;
     bool isFeasible(const vector<int>& solution) const;
+
     set<int> getUniverse() const;
     void printProblem() const;
 
@@ -30,7 +38,11 @@ public:
     double getQuadraticCoeff(int i, int j) const;
 
 private:
+    vector<int> universe; // Sorted distinct elements of all sets
+    int maxElement = 0;
+
     void readFile();
+    void buildUniverse();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "solution.hpp"
+#include <algorithm>
+
+Solution::Solution(int n) : n(n), words((n + WORD_BITS - 1) / WORD_BITS, 0) {}
+
+Solution::Solution(const vector<int>& values) : Solution(static_cast<int>(values.size())) {
+    for (int i = 0; i < n; i++) {
+        if (values[i] == 1) {
+            set(i);
+        }
+    }
+}
+
+vector<int> Solution::toVector() const {
+    vector<int> values(n, 0);
+    forEachSetBit([&](int i) { values[i] = 1; });
+    return values;
+}
+
+int Solution::count() const {
+    int total = 0;
+    for (uint64_t word : words) {
+        total += __builtin_popcountll(word);
+    }
+    return total;
+}
+
+void Solution::clear() {
+    fill(words.begin(), words.end(), 0);
+}
+
+int Solution::nextSetBit(int from) const {
+    if (from >= n) return n;
+    size_t w = from / WORD_BITS;
+    uint64_t word = words[w] & (~0ULL << (from % WORD_BITS));
+    while (true) {
+        if (word) {
+            return min(n, static_cast<int>(w * WORD_BITS + __builtin_ctzll(word)));
+        }
+        if (++w >= words.size()) return n;
+        word = words[w];
+    }
+}
+
+int Solution::hammingDistance(const Solution& other) const {
+    int distance = 0;
+    size_t common = min(words.size(), other.words.size());
+    for (size_t w = 0; w < common; w++) {
+        distance += __builtin_popcountll(words[w] ^ other.words[w]);
+    }
+    for (size_t w = common; w < words.size(); w++) {
+        distance += __builtin_popcountll(words[w]);
+    }
+    for (size_t w = common; w < other.words.size(); w++) {
+        distance += __builtin_popcountll(other.words[w]);
+    }
+    return distance;
+}
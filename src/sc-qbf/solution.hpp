@@ -0,0 +1,59 @@
+#ifndef SOLUTION_HPP
+#define SOLUTION_HPP
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Packed bit-vector of 0/1 decisions (one bit per set)
+class Solution {
+public:
+    static const int WORD_BITS = 64;
+
+private:
+    int n = 0; // Number of decision variables
+    vector<uint64_t> words;
+
+public:
+    Solution() = default;
+    explicit Solution(int n);
+    explicit Solution(const vector<int>& values); // Adapter from 0/1 array
+
+    vector<int> toVector() const; // Adapter to 0/1 array
+
+    int size() const { return n; }
+    int count() const;
+    bool empty() const { return n == 0; }
+
+    bool test(int i) const { return (words[i / WORD_BITS] >> (i % WORD_BITS)) & 1ULL; }
+    void set(int i) { words[i / WORD_BITS] |= (1ULL << (i % WORD_BITS)); }
+    void reset(int i) { words[i / WORD_BITS] &= ~(1ULL << (i % WORD_BITS)); }
+    void flip(int i) { words[i / WORD_BITS] ^= (1ULL << (i % WORD_BITS)); }
+    void assign(int i, bool value) { value ? set(i) : reset(i); }
+    void clear();
+
+    // Index of the first set bit at position >= from, or size() if there is none
+    int nextSetBit(int from) const;
+
+    // Calls f(i) for every set bit i in increasing order
+    template <typename F>
+    void forEachSetBit(F f) const {
+        for (size_t w = 0; w < words.size(); w++) {
+            uint64_t word = words[w];
+            while (word) {
+                f(static_cast<int>(w * WORD_BITS + __builtin_ctzll(word)));
+                word &= word - 1;
+            }
+        }
+    }
+
+    int hammingDistance(const Solution& other) const;
+
+    const vector<uint64_t>& getWords() const { return words; }
+
+    bool operator==(const Solution& other) const { return n == other.n && words == other.words; }
+    bool operator!=(const Solution& other) const { return !(*this == other); }
+};
+
+#endif
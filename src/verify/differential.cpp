@@ -0,0 +1,223 @@
+#include "differential.hpp"
+#include "exhaustive.hpp"
+#include "../bound/bound.hpp"
+#include "../grasp/grasp.hpp"
+#include "../sc-qbf/presolve.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <set>
+
+// Straightforward oracles, independent of the packed kernels in SetCoverQBF
+static double referenceValue(const SetCoverQBF& scqbf, const vector<int>& x) {
+    double value = 0.0;
+    int m = scqbf.getNumSets();
+    for (int i = 0; i < m; i++) {
+        if (x[i] != 1) continue;
+        value += scqbf.getLinearCoeff(i);
+        for (int j = i + 1; j < m; j++) {
+            if (x[j] == 1) value += scqbf.getQuadraticCoeff(i, j);
+        }
+    }
+    return value;
+}
+
+static bool referenceFeasible(const SetCoverQBF& scqbf, const vector<int>& x) {
+    set<int> covered;
+    for (int i = 0; i < scqbf.getNumSets(); i++) {
+        if (x[i] == 1) covered.insert(scqbf.getSet(i).begin(), scqbf.getSet(i).end());
+    }
+    return covered == scqbf.getUniverse();
+}
+
+DifferentialTester::DifferentialTester(unsigned int seed) : rng(seed) {}
+
+bool DifferentialTester::expect(bool condition, const string& message) {
+    checks++;
+    if (!condition) {
+        failures++;
+        cerr << "FAIL: " << message << endl;
+    }
+    return condition;
+}
+
+SetCoverQBF DifferentialTester::randomInstance(int m, int numElements, int maxCoeff) {
+    uniform_int_distribution<int> element(1, numElements);
+    uniform_int_distribution<int> setIndex(0, m - 1);
+    uniform_int_distribution<int> setSize(1, max(1, numElements / 2));
+    uniform_int_distribution<int> coeff(-maxCoeff, maxCoeff);
+
+    vector<set<int>> chosen(m);
+    for (int i = 0; i < m; i++) {
+        int size = setSize(rng);
+        for (int k = 0; k < size; k++) chosen[i].insert(element(rng));
+    }
+    for (int e = 1; e <= numElements; e++) {
+        chosen[setIndex(rng)].insert(e);
+    }
+
+    vector<vector<int>> sets(m), A(m);
+    for (int i = 0; i < m; i++) {
+        sets[i].assign(chosen[i].begin(), chosen[i].end());
+        for (int j = i; j < m; j++) A[i].push_back(coeff(rng));
+    }
+
+    return SetCoverQBF(sets, A);
+}
+
+bool DifferentialTester::checkMoves(const SetCoverQBF& scqbf, int numMoves) {
+    int failuresBefore = failures;
+    int m = scqbf.getNumSets();
+    if (m == 0) return true;
+
+    uniform_int_distribution<int> var(0, m - 1);
+    uniform_int_distribution<int> coin(0, 1);
+
+    Solution start(m);
+    for (int i = 0; i < m; i++) {
+        if (coin(rng)) start.set(i);
+    }
+    Solution solution = start;
+    vector<int> x = solution.toVector();
+
+    auto flip = [&](int i) {
+        x[i] = 1 - x[i];
+        solution.flip(i);
+    };
+
+    for (int move = 0; move < numMoves; move++) {
+        int i = var(rng);
+        int j = var(rng);
+        string moveName;
+        if (coin(rng) && x[i] != x[j]) {
+            moveName = "swap(" + to_string(i) + "," + to_string(j) + ")";
+            flip(i);
+            flip(j);
+        } else {
+            moveName = "flip(" + to_string(i) + ")";
+            flip(i);
+        }
+
+        string where = scqbf.path + " move " + to_string(move) + " " + moveName;
+        double full = referenceValue(scqbf, x);
+        bool feasible = referenceFeasible(scqbf, x);
+
+        // Incremental gain used by GRASP construction against full recomputation
+        for (int c = 0; c < m; c++) {
+            if (x[c]) continue;
+            Solution added = solution;
+            added.set(c);
+            double gain = GRASP::objectiveGain(scqbf, solution, c);
+            double recomputed = scqbf.evaluateSolution(added) - scqbf.evaluateSolution(solution);
+            expect(fabs(gain - recomputed) < 1e-6, where + ": GRASP::objectiveGain(" + to_string(c) + ") "
+                + to_string(gain) + " != recomputed " + to_string(recomputed));
+        }
+        expect(fabs(scqbf.evaluateSolution(solution) - full) < 1e-6, where + ": evaluateSolution(Solution)");
+        expect(fabs(scqbf.evaluateSolution(x) - full) < 1e-6, where + ": evaluateSolution(vector)");
+        expect(scqbf.isFeasible(solution) == feasible, where + ": isFeasible(Solution)");
+        expect(scqbf.isFeasible(x) == feasible, where + ": isFeasible(vector)");
+
+        // Packed representation against the plain array
+        int ones = static_cast<int>(count(x.begin(), x.end(), 1));
+        int distance = 0;
+        for (int k = 0; k < m; k++) distance += (x[k] != static_cast<int>(start.test(k)));
+        int iterated = 0;
+        for (int k = solution.nextSetBit(0); k < m; k = solution.nextSetBit(k + 1)) {
+            iterated += x[k];
+        }
+        expect(solution.toVector() == x, where + ": Solution::toVector");
+        expect(Solution(x) == solution, where + ": Solution(vector)");
+        expect(solution.count() == ones && iterated == ones, where + ": Solution::count/nextSetBit");
+        expect(solution.hammingDistance(start) == distance, where + ": Solution::hammingDistance");
+    }
+
+    return failures == failuresBefore;
+}
+
+bool DifferentialTester::checkSubsets(const SetCoverQBF& scqbf, int maxEnumerated) {
+    int failuresBefore = failures;
+    if (scqbf.getNumSets() > maxEnumerated) return true;
+
+    ExhaustiveSolver solver(scqbf);
+    solver.enumerate([&](uint64_t mask, double value, bool feasible) {
+        Solution solution = solver.toSolution(mask);
+        vector<int> x = solution.toVector();
+        string where = scqbf.path + " subset " + to_string(mask);
+        expect(fabs(referenceValue(scqbf, x) - value) < 1e-6, where + ": exhaustive value");
+        expect(referenceFeasible(scqbf, x) == feasible, where + ": exhaustive coverage");
+        expect(fabs(scqbf.evaluateSolution(solution) - value) < 1e-6, where + ": evaluateSolution");
+        expect(scqbf.isFeasible(solution) == feasible, where + ": isFeasible");
+    });
+
+    return failures == failuresBefore;
+}
+
+bool DifferentialTester::checkOptimum(const SetCoverQBF& scqbf, const string& name) {
+    int failuresBefore = failures;
+    if (scqbf.getNumSets() > ExhaustiveSolver::MAX_SETS) return true;
+
+    ExhaustiveSolver solver(scqbf);
+    double optimum = solver.solve();
+    if (!expect(solver.hasFeasible(), name + ": no feasible subset")) return false;
+
+    Solution best = solver.getBestSolution();
+    expect(fabs(scqbf.evaluateSolution(best) - optimum) < 1e-6, name + ": optimum value");
+    expect(scqbf.isFeasible(best), name + ": optimum feasibility");
+
+    Presolve presolve(scqbf);
+    const SetCoverQBF& reduced = presolve.getReduced();
+    ExhaustiveSolver reducedSolver(reduced);
+    double reducedOptimum = reducedSolver.solve() + presolve.getOffset();
+    Solution expanded = presolve.expand(reducedSolver.getBestSolution());
+    expect(reducedSolver.hasFeasible() && reducedOptimum == optimum, name + ": presolved optimum "
+        + to_string(reducedOptimum) + " != optimum " + to_string(optimum));
+    expect(scqbf.isFeasible(expanded), name + ": expanded presolved optimum infeasible");
+    expect(fabs(scqbf.evaluateSolution(expanded) - optimum) < 1e-6, name + ": expanded presolved optimum value");
+
+    UpperBound bounder(scqbf);
+    double root = bounder.rootBound();
+    double bound = bounder.compute();
+    expect(root >= optimum, name + ": root bound " + to_string(root) + " below optimum " + to_string(optimum));
+    expect(bound >= optimum, name + ": bound " + to_string(bound) + " below optimum " + to_string(optimum));
+    if (bounder.isProvenOptimal()) {
+        expect(bound == optimum, name + ": proven bound " + to_string(bound) + " != optimum " + to_string(optimum));
+    }
+
+    GRASP grasp(0.1, 20, 5);
+    grasp.setBoundNodeLimit(0);
+    streambuf* coutBuffer = cout.rdbuf(nullptr);
+    Solution graspSolution = grasp.solve(scqbf);
+    cout.rdbuf(coutBuffer);
+    expect(scqbf.isFeasible(graspSolution), name + ": GRASP solution infeasible");
+    expect(scqbf.evaluateSolution(graspSolution) <= optimum, name + ": GRASP value above optimum");
+
+    cout << name << ": m=" << scqbf.getNumSets() << " optimum=" << optimum
+        << " bound=" << bound << (bounder.isProvenOptimal() ? " (proven)" : "")
+        << " grasp=" << scqbf.evaluateSolution(graspSolution)
+        << " presolved_sets=" << reduced.getNumSets() << endl;
+
+    return failures == failuresBefore;
+}
+
+bool DifferentialTester::runAll(const vector<string>& paths, int numGenerated, int maxSets) {
+    for (const auto& path : paths) {
+        SetCoverQBF scqbf(path);
+        checkMoves(scqbf, 500);
+        checkSubsets(scqbf);
+        checkOptimum(scqbf, path);
+    }
+
+    uniform_int_distribution<int> sizes(2, max(2, maxSets));
+    for (int k = 0; k < numGenerated; k++) {
+        int m = sizes(rng);
+        uniform_int_distribution<int> elements(1, 2 * m);
+        SetCoverQBF scqbf = randomInstance(m, elements(rng));
+        scqbf.path = "generated-" + to_string(k);
+        checkMoves(scqbf, 500);
+        checkSubsets(scqbf);
+        checkOptimum(scqbf, scqbf.path);
+    }
+
+    cout << "Differential checks: " << checks << " run, " << failures << " failed" << endl;
+    return failures == 0;
+}
@@ -0,0 +1,47 @@
+#ifndef DIFFERENTIAL_HPP
+#define DIFFERENTIAL_HPP
+
+#include "../sc-qbf/sc_qbf.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Randomized differential checks of the fast kernels against full recomputation
+// and against the exhaustive reference solver
+class DifferentialTester {
+private:
+    mt19937 rng;
+    int failures = 0;
+    int checks = 0;
+
+public:
+    DifferentialTester(unsigned int seed = 12345);
+
+    // Random instance with m sets over elements 1..numElements (every element is covered)
+    SetCoverQBF randomInstance(int m, int numElements, int maxCoeff = 10);
+
+    // Applies random flip/swap moves and after every move compares GRASP::objectiveGain for each
+    // unselected set with recomputed value differences, and evaluateSolution/isFeasible with the
+    // reference oracles (feasibility is always recomputed in full; there is no incremental coverage)
+    bool checkMoves(const SetCoverQBF& scqbf, int numMoves);
+
+    // Compares every subset enumerated by the exhaustive solver with
+    // evaluateSolution/isFeasible (only for m <= maxEnumerated)
+    bool checkSubsets(const SetCoverQBF& scqbf, int maxEnumerated = 16);
+
+    // Checks the exhaustive optimum against the upper bound and against GRASP
+    bool checkOptimum(const SetCoverQBF& scqbf, const string& name);
+
+    // Runs every check on the given instance files and on generated instances
+    bool runAll(const vector<string>& paths, int numGenerated = 20, int maxSets = 20);
+
+    int getFailures() const { return failures; }
+    int getChecks() const { return checks; }
+
+private:
+    bool expect(bool condition, const string& message);
+};
+
+#endif
@@ -0,0 +1,57 @@
+#include "exhaustive.hpp"
+#include <map>
+#include <stdexcept>
+
+ExhaustiveSolver::ExhaustiveSolver(const SetCoverQBF& scqbf)
+    : m(scqbf.getNumSets()), bestValue(-1e18) {
+    if (m > MAX_SETS) {
+        throw invalid_argument("ExhaustiveSolver supports at most " + to_string(MAX_SETS) + " sets");
+    }
+
+    linear.assign(m, 0);
+    Q.assign(m, vector<long long>(m, 0));
+    for (int i = 0; i < m; i++) {
+        linear[i] = static_cast<long long>(scqbf.getLinearCoeff(i));
+        for (int j = i + 1; j < m; j++) {
+            Q[i][j] = Q[j][i] = static_cast<long long>(scqbf.getQuadraticCoeff(i, j));
+        }
+    }
+
+    map<int, int> elementIndex;
+    for (int element : scqbf.getUniverse()) {
+        int index = static_cast<int>(elementIndex.size());
+        elementIndex[element] = index;
+    }
+    numElements = static_cast<int>(elementIndex.size());
+
+    setElements.assign(m, {});
+    for (int i = 0; i < m; i++) {
+        for (int element : scqbf.getSet(i)) {
+            setElements[i].push_back(elementIndex[element]);
+        }
+    }
+}
+
+double ExhaustiveSolver::solve() {
+    bestValue = -1e18;
+    bestMask = 0;
+    feasibleFound = false;
+
+    enumerate([&](uint64_t mask, double value, bool feasible) {
+        if (feasible && (!feasibleFound || value > bestValue)) {
+            bestValue = value;
+            bestMask = mask;
+            feasibleFound = true;
+        }
+    });
+
+    return bestValue;
+}
+
+Solution ExhaustiveSolver::toSolution(uint64_t mask) const {
+    Solution solution(m);
+    for (int i = 0; i < m; i++) {
+        if ((mask >> i) & 1ULL) solution.set(i);
+    }
+    return solution;
+}
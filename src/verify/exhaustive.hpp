@@ -0,0 +1,74 @@
+#ifndef EXHAUSTIVE_HPP
+#define EXHAUSTIVE_HPP
+
+#include "../sc-qbf/sc_qbf.hpp"
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Reference solver for small instances: enumerates all 2^m subsets in Gray-code order,
+// with subsets as bit masks and value/coverage updated incrementally on every flip
+class ExhaustiveSolver {
+public:
+    static const int MAX_SETS = 30;
+
+private:
+    int m;
+    vector<long long> linear;
+    vector<vector<long long>> Q; // Symmetric dense matrix of quadratic coefficients
+    vector<vector<int>> setElements; // Elements of each set, as universe indexes
+    int numElements;
+
+    double bestValue;
+    uint64_t bestMask = 0;
+    bool feasibleFound = false;
+
+public:
+    ExhaustiveSolver(const SetCoverQBF& scqbf);
+
+    // Returns the optimal value, or -1e18 if no subset is feasible
+    double solve();
+
+    // Calls visit(mask, value, feasible) for every subset, including the empty one
+    template <typename F>
+    void enumerate(F visit) const {
+        vector<long long> gain(linear); // Value change of adding each set to the current subset
+        vector<int> coverCount(numElements, 0);
+        int uncovered = numElements;
+        long long value = 0;
+        uint64_t mask = 0;
+
+        visit(mask, static_cast<double>(value), uncovered == 0);
+
+        uint64_t total = 1ULL << m;
+        for (uint64_t t = 1; t < total; t++) {
+            int k = __builtin_ctzll(t);
+            uint64_t bit = 1ULL << k;
+            mask ^= bit;
+
+            if (mask & bit) {
+                value += gain[k];
+                for (int j = 0; j < m; j++) gain[j] += Q[k][j];
+                for (int e : setElements[k]) {
+                    if (coverCount[e]++ == 0) uncovered--;
+                }
+            } else {
+                for (int j = 0; j < m; j++) gain[j] -= Q[k][j];
+                value -= gain[k];
+                for (int e : setElements[k]) {
+                    if (--coverCount[e] == 0) uncovered++;
+                }
+            }
+
+            visit(mask, static_cast<double>(value), uncovered == 0);
+        }
+    }
+
+    bool hasFeasible() const { return feasibleFound; }
+    double getBestValue() const { return bestValue; }
+    Solution getBestSolution() const { return toSolution(bestMask); }
+    Solution toSolution(uint64_t mask) const;
+};
+
+#endif